@@ -0,0 +1,171 @@
+#ifndef BITMAPINDEX_H
+#define BITMAPINDEX_H
+
+#include "heapfile.h"
+
+
+// A set of tuples of a heap file, kept as a bitmap with a bit for each
+// possible RID: slot s of page p is bit p * BITMAPPAGESLOTS + s.  The
+// bitmap is compressed by word-aligned hybrid (WAH) coding.  It is cut
+// into groups of 31 bits, and stored as a sequence of 32-bit words:
+//
+//   0 b30..b0            a literal word, holding one group as is
+//   1 v n29..n0          a fill word, standing for n groups whose bits
+//                        are all v
+//
+// Runs of empty or full groups, such as the slots past the end of
+// each page, thus take a single word, and bitmaps are combined with
+// AND and OR word by word without being decompressed.  Groups past
+// the last word are empty.
+
+// bits of a page in a bitmap, enough for every slot a page can have
+const int BITMAPPAGESLOTS = PAGEDATASIZE / sizeof(slot_t) + 1;
+
+class Bitmap
+{
+public:
+  Bitmap() : groupCnt(0) {}
+
+  // set bit pos, which must follow every bit set before
+  void append(const unsigned int pos);
+
+  // set bit pos, which may lie anywhere, and clear it
+  void set(const unsigned int pos);
+  void clear(const unsigned int pos);
+
+  // true if bit pos is set
+  const bool test(const unsigned int pos) const;
+
+  // number of bits set
+  const int count() const;
+
+  // RIDs of the bits set, in RID order
+  void getRids(vector<RID> & rids) const;
+
+  // a AND b, a OR b and a AND NOT b
+  static void andOf(const Bitmap & a, const Bitmap & b, Bitmap & result);
+  static void orOf(const Bitmap & a, const Bitmap & b, Bitmap & result);
+  static void andNotOf(const Bitmap & a, const Bitmap & b, Bitmap & result);
+
+  static const unsigned int ridPos(const RID & rid)
+  {
+    return (unsigned int) rid.pageNo * BITMAPPAGESLOTS + rid.slotNo;
+  }
+
+private:
+  friend class BitmapIndex;
+
+  vector<unsigned int> words;	// the compressed bitmap
+  unsigned int	groupCnt;	// groups coded by words
+
+  enum BitOp { AND, OR, ANDNOT };
+  static void combine(const Bitmap & a, const Bitmap & b, const BitOp op,
+		      Bitmap & result);
+
+  // add n groups of bits v, or one group of bits g
+  void appendFill(const bool v, unsigned int n);
+  void appendGroup(const unsigned int g);
+};
+
+
+// An index holding a bitmap of the tuples of a heap file for each
+// distinct value of an attribute.  The values and the first page of
+// their bitmaps are kept in the header page, which limits the index to
+// attributes with few distinct values; the words of a bitmap are on a
+// chain of pages.  A predicate on the attribute is evaluated as the OR
+// of the bitmaps of the values that satisfy it.
+//
+// An update of a bitmap reads and writes all of its pages, so bitmap
+// indexes suit relations that are mostly read.
+
+struct BitmapHdrPage
+{
+  char		fileName[MAXNAMESIZE];	// name of file
+  int		keyType;	// Datatype of the keys
+  int		keyLen;		// length of a key in bytes
+  int		valueCnt;	// number of distinct values
+  int		entryCnt;	// number of tuples indexed
+  int		pageCnt;	// number of bitmap pages
+  char		data[1];	// valueCnt triples (key, firstPage, wordCnt)
+};
+
+const int BITMAPHDRDATA = PAGESIZE - MAXNAMESIZE - 5 * sizeof(int);
+
+// a page of the words of a bitmap
+const int BITMAPPAGEWORDS = (PAGESIZE - 2 * sizeof(int)) / sizeof(int);
+
+struct BitmapPage
+{
+  int		nextPage;	// next page of the bitmap, -1 if none
+  int		wordCnt;	// number of words on this page
+  unsigned int	words[BITMAPPAGEWORDS];
+};
+
+
+// routines to create and destroy the file of an index
+extern const Status createBitmapIndex(const string fileName,
+				      const Datatype keyType,
+				      const int keyLen);
+extern const Status destroyBitmapIndex(const string fileName);
+
+
+class BitmapIndex
+{
+public:
+  // open the index in file fileName
+  BitmapIndex(const string & fileName, Status & status);
+
+  // close the file
+  ~BitmapIndex();
+
+  // add the tuple with RID rid to the bitmap of key; DIROVERFLOW if
+  // key is new and the header page has no room for it
+  const Status insertEntry(const char* key, const RID & rid);
+
+  // add the tuples of bits to the bitmap of key
+  const Status insertEntries(const char* key, const Bitmap & bits);
+
+  // remove the tuple with RID rid, RECNOTFOUND if it is not indexed
+  const Status deleteEntry(const char* key, const RID & rid);
+
+  // the tuples whose key satisfies key op value
+  const Status select(const Operator op, const char* value, Bitmap & bits);
+
+  const int getEntryCnt() const { return headerPage->entryCnt; }
+  const int getValueCnt() const { return headerPage->valueCnt; }
+  const int getPageCnt() const { return headerPage->pageCnt; }
+  const int getValueCap() const { return valueCap; }
+
+private:
+  File*		filePtr;	// underlying DB File object
+  BitmapHdrPage* headerPage;	// pinned header page
+  int		headerPageNo;
+  bool		hdrDirtyFlag;
+  Datatype	keyType;
+  int		keyLen;
+  int		valueLen;	// key + first page + word count
+  int		valueCap;	// max # values of the header page
+
+  const int keyCmp(const char* a, const char* b) const;
+
+  // copy key to norm, padding strings with nulls and making -0.0 0.0
+  void normalKey(const char* key, char* norm) const;
+
+  // key of value i, and the first page and word count of its bitmap
+  char* valueKey(const int i) const
+  {
+    return headerPage->data + i * valueLen;
+  }
+  void getValue(const int i, int & firstPage, int & wordCnt) const;
+  void setValue(const int i, const int firstPage, const int wordCnt);
+
+  // value holding key, -1 if there is none
+  const int findValue(const char* key) const;
+
+  // read and write the bitmap of value i; writing an empty bitmap
+  // removes the value
+  const Status readBitmap(const int i, Bitmap & bits);
+  const Status writeBitmap(const int i, const Bitmap & bits);
+};
+
+#endif
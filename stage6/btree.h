@@ -0,0 +1,181 @@
+#ifndef BTREE_H
+#define BTREE_H
+
+#include "heapfile.h"
+
+
+// define if debug output wanted
+//#define DEBUGIND
+
+
+// A B+-tree over the records of a heap file.  Every entry is a pair
+// (key, RID); entries are ordered by key and then by RID, so that
+// duplicate keys need no special handling and every entry can be
+// found by a descent from the root.  Each node is one page of the
+// index file, read through the buffer pool.
+//
+// Deletions only remove the entry from its leaf; nodes are never
+// merged, and scans step over leaves left empty.
+//
+// A leaf entry may carry the values of some other attributes of its
+// tuple after the RID, so that a query referring only to the key and
+// these included attributes can be answered from the leaves without
+// reading the tuples.  Separators of internal nodes never carry them.
+//
+// An empty tree can also be bulk loaded from entries in (key, RID)
+// order.  Leaves are filled left to right and each level above is
+// built as the nodes below it are completed, every node being filled
+// to a fraction of its capacity so that later inserts find room.
+
+// fraction of a node filled by a bulk load
+#define BTREEFILLFACTOR 0.9
+
+struct BTreeHdrPage
+{
+  char		fileName[MAXNAMESIZE];	// name of file
+  int		rootPage;	// pageNo of root node
+  int		height;		// number of levels, 1 if the root is a leaf
+  int		keyType;	// Datatype of the keys
+  int		keyLen;		// length of a key in bytes
+  int		entryCnt;	// number of (key, RID) entries
+  int		nodeCnt;	// number of nodes
+  int		inclLen;	// bytes of included attributes per leaf entry
+};
+
+// a node of the tree.  A leaf holds keyCnt entries (key, RID, included
+// attributes); an
+// internal node holds child pointer 0 followed by keyCnt triples
+// (key, RID, child), child i + 1 having entries >= separator i.
+
+const int BTNODEDATA = PAGESIZE - 3 * sizeof(int);
+
+struct BTreeNode
+{
+  int		level;		// 0 for leaves
+  int		keyCnt;		// number of entries or separators
+  int		nextPage;	// right sibling of a leaf, -1 if none
+  char		data[BTNODEDATA];
+};
+
+
+// routines to create and destroy the file of an index; leaf entries
+// carry inclLen bytes of included attributes
+extern const Status createBTreeIndex(const string fileName,
+				     const Datatype keyType,
+				     const int keyLen,
+				     const int inclLen = 0);
+extern const Status destroyBTreeIndex(const string fileName);
+
+
+class BTreeIndex
+{
+public:
+  // open the index in file fileName
+  BTreeIndex(const string & fileName, Status & status);
+
+  // end any scan and close the file
+  ~BTreeIndex();
+
+  // add the entry (key, rid); key points to keyLen bytes and incl to
+  // the included attributes, or is NULL if there are none
+  const Status insertEntry(const char* key, const RID & rid,
+			   const char* incl = NULL);
+
+  // remove the entry (key, rid), RECNOTFOUND if there is none
+  const Status deleteEntry(const char* key, const RID & rid);
+
+  // start a scan of the entries with low lowOp key and key highOp high,
+  // lowOp being GT or GTE and highOp LT or LTE.  A NULL bound leaves
+  // that end of the range open.
+  const Status startScan(const char* low, const Operator lowOp,
+			 const char* high, const Operator highOp);
+
+  // return the RID of the next entry of the scan, NOMORERECS at the end
+  const Status scanNext(RID & rid);
+
+  // same, also copying the key and the included attributes of the
+  // entry to key and incl unless they are NULL
+  const Status scanNext(RID & rid, char* key, char* incl);
+
+  // end the scan
+  const Status endScan();
+
+  // start a bulk load of the empty tree, filling nodes to fillFactor
+  const Status startBulkLoad(const double fillFactor);
+
+  // append the entry (key, rid), which must follow the entries
+  // appended before it
+  const Status bulkAppend(const char* key, const RID & rid,
+			  const char* incl = NULL);
+
+  // finish the bulk load, making the top node the root
+  const Status endBulkLoad();
+
+  const int getEntryCnt() const { return headerPage->entryCnt; }
+  const int getHeight() const { return headerPage->height; }
+  const int getNodeCnt() const { return headerPage->nodeCnt; }
+  const int getInclLen() const { return inclLen; }
+
+private:
+  File*		filePtr;	// underlying DB File object
+  BTreeHdrPage*	headerPage;	// pinned header page
+  int		headerPageNo;
+  bool		hdrDirtyFlag;
+  Datatype	keyType;
+  int		keyLen;
+  int		entryLen;	// key + RID
+  int		inclLen;	// included attributes of a leaf entry
+  int		leafLen;	// entryLen + inclLen
+  int		leafCap;	// max # entries of a leaf
+  int		innerCap;	// max # separators of an internal node
+
+  // scan state; the current leaf stays pinned during a scan
+  int		scanPageNo;	// -1 if no scan is active
+  BTreeNode*	scanPage;
+  int		scanPos;	// next entry of scanPage
+  vector<char>	scanLow;	// bounds of the scan, empty if open
+  vector<char>	scanHigh;
+  Operator	scanLowOp;
+  Operator	scanHighOp;
+
+  // bulk load state: the rightmost node of each level stays pinned
+  vector<int>	bulkPages;	// empty if no bulk load is active
+  vector<BTreeNode*> bulkNodes;
+  vector<char>	bulkLast;	// entry appended last
+  int		leafFill;	// # entries of a full leaf
+  int		innerFill;	// # separators of a full internal node
+
+  // compare keys only, and whole (key, RID) entries
+  const int keyCmp(const char* a, const char* b) const;
+  const int entryCmp(const char* a, const char* b) const;
+
+  // entry i of a leaf, separator i and child i of an internal node
+  char* leafEntry(BTreeNode* node, const int i) const
+  {
+    return node->data + i * leafLen;
+  }
+  char* innerEntry(BTreeNode* node, const int i) const
+  {
+    return node->data + sizeof(int) + i * (entryLen + sizeof(int));
+  }
+  const int getChild(BTreeNode* node, const int i) const;
+  void setChild(BTreeNode* node, const int i, const int pageNo) const;
+
+  // child of an internal node to descend to for entry
+  const int childPos(BTreeNode* node, const char* entry) const;
+
+  // insert entry below node pageNo; if the node splits, split is
+  // set and the separator and new right node are returned
+  const Status insertInto(const int pageNo, const char* entry,
+			  bool & split, char* upEntry, int & upPage);
+
+  // allocate and initialize a node
+  const Status newNode(const int level, int & pageNo, BTreeNode*& node);
+
+  // add separator sep and child right to the rightmost node of level;
+  // left is the node before right, the first child of a new level
+  const Status bulkSeparator(const unsigned int level, const char* sep,
+			     const int left, const int right);
+};
+
+#endif
@@ -97,6 +97,43 @@ struct BufStats
 };
 
 
+// A PinGuard owns one pin on a page in the buffer pool and unpins
+// the page when it goes away.  Guards can be moved but not copied, so
+// a pin handed out through a guard is released exactly once.
+
+class PinGuard
+{
+  friend class BufMgr;
+
+public:
+  PinGuard() : mgr(NULL), file(NULL), pageNo(-1), page(NULL), dirty(false) {}
+  PinGuard(PinGuard&& other);
+  PinGuard& operator=(PinGuard&& other);
+  ~PinGuard()
+    {
+      release();
+    }
+
+  PinGuard(const PinGuard&) = delete;
+  PinGuard& operator=(const PinGuard&) = delete;
+
+  Page* getPage() const { return page; }
+  const int getPageNo() const { return pageNo; }
+  const bool isPinned() const { return page != NULL; }
+  void markDirty() { dirty = true; }
+
+  // unpin the page now instead of when the guard goes away
+  const Status release();
+
+private:
+  BufMgr*	mgr;	// buffer manager holding the pin, NULL if none
+  File*		file;
+  int		pageNo;
+  Page*		page;
+  bool		dirty;	// page is unpinned dirty
+};
+
+
 class BufMgr 
 {
 private:
@@ -122,12 +159,22 @@ public:
 
   const Status readPage(File* file, const int PageNo, Page*& page);
   const Status unPinPage(File* file, const int PageNo, const bool dirty);
+
+  // pin a page and hand the pin to guard, which gives up its old pin
+  const Status pinPage(File* file, const int PageNo, PinGuard& guard);
   const Status allocPage(File* file, int& PageNo, Page*& page); 
                         // allocates a new, empty page 
   const Status flushFile(const File* file); // writing out all dirty pages of the file
   const Status disposePage(File* file, const int PageNo); // dispose of page in file
   void  printSelf();
 
+  const int getNumBufs() const // number of frames in buffer pool
+  {
+	return numBufs;
+  }
+
+  const int getNumUnpinned() const; // number of frames with no pinned page
+
   const BufStats & getBufStats() const // get buffer pool usage
   {
 	return bufStats;
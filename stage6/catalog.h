@@ -1,6 +1,9 @@
 #ifndef CATALOG_H
 #define CATALOG_H
 
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "heapfile.h"
 
 
@@ -10,6 +13,8 @@
 
 #define RELCATNAME   "relcat"           // name of relation catalog
 #define ATTRCATNAME  "attrcat"          // name of attribute catalog
+#define STATCATNAME  "statcat"          // name of statistics catalog
+#define IDXCATNAME   "idxcat"           // name of index catalog
 #define MAXNAME      32                 // length of relName, attrName
 #define MAXSTRINGLEN 255                // max. length of string attribute
 
@@ -34,6 +39,10 @@ typedef struct {
 } attrInfo; 
 
 
+// kinds of index an attribute may have
+enum IndexType { BTREEINDEX, HASHINDEX, BITMAPINDEX };
+
+
 class RelCatalog : public HeapFile {
  public:
   // open relation catalog
@@ -56,11 +65,37 @@ class RelCatalog : public HeapFile {
   // destroy a relation
   const Status destroyRel(const string & relation);
 
+  // build an index on an attribute of a relation; a hash index
+  // starts out with at least bucketCnt buckets, and the leaf entries
+  // of a B+-tree carry the attributes inclNames
+  const Status addIndex(const string & relation, const string & attrName,
+			const IndexType indexType = BTREEINDEX,
+			const int bucketCnt = 1,
+			const vector<string> & inclNames = vector<string>());
+
+  // replace any index on an attribute by a new one, which is built
+  // before the old one is dropped
+  const Status replaceIndex(const string & relation,
+			    const string & attrName,
+			    const IndexType indexType,
+			    const int bucketCnt = 1);
+
+  // drop the index on an attribute, or all indexes of the relation
+  // if attrName is empty
+  const Status dropIndex(const string & relation, const string & attrName);
+
   // print catalog information
   const Status help(const string & relation);          // relation may be NULL
 
   // get rid of catalog
   ~RelCatalog();
+
+ private:
+  // relcat tuples by relation name, read when the catalog is opened
+  unordered_map<string, RelDesc> relCache;
+
+  // read relcat into relCache
+  const Status loadCache();
 };
 
 
@@ -109,13 +144,149 @@ class AttrCatalog : public HeapFile {
 
   // close attribute catalog
   ~AttrCatalog();
+
+ private:
+  // attrcat tuples by relation name, in catalog order, and by
+  // (relation, attribute) name, read when the catalog is opened
+  unordered_map<string, vector<AttrDesc> > relAttrs;
+  unordered_map<string, AttrDesc> attrCache;
+
+  // read attrcat into relAttrs and attrCache
+  const Status loadCache();
 };
 
 
+// schema of statistics catalog, one tuple per attribute of each
+// analyzed relation:
+//   relation name : char(32)           <-- lookup keys
+//   attribute name : char(32)          <--
+//   followed by the statistics below.  Values of the attribute are
+//   stored in binary in STATVALLEN bytes; longer strings are cut.
+
+#define HISTBUCKETS  10                 // buckets of a histogram
+#define MAXMCVS      5                  // most common values kept
+#define STATVALLEN   16                 // bytes kept of a value
+
+
+typedef struct {
+  char relName[MAXNAME];                // relation name
+  char attrName[MAXNAME];               // attribute name
+  int attrType;                         // attribute type
+  int recCnt;                           // # tuples when analyzed
+  int pageCnt;                          // # data pages when analyzed
+  int sampleCnt;                        // # tuples in the sample
+  int ndv;                              // estimated # distinct values
+  char minVal[STATVALLEN];              // smallest value in the sample
+  char maxVal[STATVALLEN];              // largest value in the sample
+  int bucketCnt;                        // # histogram buckets in use
+  char bounds[HISTBUCKETS][STATVALLEN]; // upper bounds of equi-depth
+                                        // buckets of recCnt/bucketCnt
+                                        // tuples each
+  int mcvCnt;                           // # most common values
+  char mcvVals[MAXMCVS][STATVALLEN];    // most common values
+  float mcvFreqs[MAXMCVS];              // their fractions of the tuples
+} StatDesc;
+
+
+class StatCatalog : public HeapFile {
+ public:
+  // open statistics catalog
+  StatCatalog(Status &status);
+
+  // get statistics of an attribute
+  const Status getInfo(const string & relation,
+		       const string & attrName,
+		       StatDesc &record);
+
+  // add statistics of an attribute, replacing older ones
+  const Status addInfo(StatDesc & record);
+
+  // delete all statistics of a relation
+  const Status removeInfo(const string & relation);
+
+  // close statistics catalog
+  ~StatCatalog();
+
+ private:
+  // statcat tuples by (relation, attribute) name
+  unordered_map<string, StatDesc> statCache;
+
+  // read statcat into statCache
+  const Status loadCache();
+};
+
+
+// schema of index catalog, one tuple per index:
+//   relation name : char(32)           <-- lookup keys
+//   attribute name : char(32)          <--
+//   attribute offset, type and length of the key
+//   index type : integer(4)
+//   names, offsets and lengths of the included attributes
+
+#define MAXINCLATTRS 4                  // attributes included in an index
+
+typedef struct {
+  char relName[MAXNAME];                // relation name
+  char attrName[MAXNAME];               // attribute name
+  int attrOffset;                       // offset of key attribute
+  int attrType;                         // type of key attribute
+  int attrLen;                          // length of key attribute
+  int indexType;                        // IndexType of the index
+  int inclCnt;                          // # of included attributes
+  char inclNames[MAXINCLATTRS][MAXNAME]; // included attributes, stored
+  int inclOffsets[MAXINCLATTRS];        // in this order after the RID
+  int inclLens[MAXINCLATTRS];           // of a leaf entry
+} IndexDesc;
+
+
+class IndexCatalog : public HeapFile {
+ public:
+  // open index catalog
+  IndexCatalog(Status &status);
+
+  // get the index on an attribute, NOINDEX if there is none
+  const Status getInfo(const string & relation,
+		       const string & attrName,
+		       IndexDesc &record);
+
+  // get all indexes of a relation; OK with no indexes
+  const Status getRelInfo(const string & relation,
+			  vector<IndexDesc> & indexes);
+
+  // add an index to catalog
+  const Status addInfo(IndexDesc & record);
+
+  // remove the index on an attribute from catalog
+  const Status removeInfo(const string & relation, const string & attrName);
+
+  // close index catalog
+  ~IndexCatalog();
+
+ private:
+  // idxcat tuples by relation name
+  unordered_map<string, vector<IndexDesc> > relIndexes;
+
+  // read idxcat into relIndexes
+  const Status loadCache();
+};
+
+
+// name of the file holding the index on relation.attrName
+extern const string indexFileName(const string & relation,
+				  const string & attrName);
+
+
 extern RelCatalog  *relCat;
 extern AttrCatalog *attrCat;
+extern StatCatalog *statCat;
+extern IndexCatalog *idxCat;
 extern Error error;
 extern Status createHeapFile(const string filename);
 extern Status destroyHeapFile(const string filename);
 
+// returns a counter that is bumped on every change to relcat, attrcat,
+// statcat or idxcat, so that other caches of catalog information can tell
+// whether they have gone stale
+extern const int getCatalogVersion();
+
 #endif
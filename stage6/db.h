@@ -42,6 +42,8 @@ class File {
 
   static const Status create(const string &fileName);
   static const Status destroy(const string &fileName);
+  static const Status rename(const string &fileName,
+			     const string &newName);
 
   const Status open();
   const Status close();
@@ -106,6 +108,8 @@ class DB {
   const Status createFile(const string & fileName) ;  // create a new file
   const Status destroyFile(const string & fileName) ; // destroy a file, 
                                                            // release all space
+  const Status renameFile(const string & fileName,
+			  const string & newName); // rename a closed file
   const Status openFile(const string & fileName, File* & file);  // open a file
   const Status closeFile(File* file);         // close a file
 
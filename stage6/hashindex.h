@@ -0,0 +1,146 @@
+#ifndef HASHINDEX_H
+#define HASHINDEX_H
+
+#include "heapfile.h"
+
+
+// An extendible hash index over the records of a heap file.  Every
+// entry is a pair (key, RID).  A directory of 2^globalDepth slots,
+// indexed by the low bits of the hash of a key, holds the page number
+// of the bucket of the key; a bucket of local depth d is shared by the
+// 2^(globalDepth - d) slots that agree on the low d bits.  A full
+// bucket is split in two, doubling the directory first if its local
+// depth equals the global depth.  Entries whose keys all hash alike
+// cannot be separated by a split and go to overflow pages chained to
+// the bucket.  Directory and bucket pages are read through the buffer
+// pool.
+//
+// An entry is not looked for before it is added, so the same (key, RID)
+// must not be added twice.  Deletions only remove the entry from its
+// page; buckets are never merged and the directory never shrinks.
+
+// directory slots per page, and the largest directory allowed
+const int HASHDIRSLOTS = PAGESIZE / sizeof(int);
+const int HASHMAXDEPTH = 15;
+const int HASHMAXDIRPAGES = (1 << HASHMAXDEPTH) / HASHDIRSLOTS;
+
+struct HashHdrPage
+{
+  char		fileName[MAXNAMESIZE];	// name of file
+  int		keyType;	// Datatype of the keys
+  int		keyLen;		// length of a key in bytes
+  int		globalDepth;	// directory has 2^globalDepth slots
+  int		entryCnt;	// number of (key, RID) entries
+  int		bucketCnt;	// number of buckets
+  int		overflowCnt;	// number of overflow pages
+  int		dirPageCnt;	// number of directory pages
+  int		dirPages[HASHMAXDIRPAGES]; // pageNos of the directory
+};
+
+// a bucket page, or an overflow page of a bucket.  It holds keyCnt
+// entries (key, RID) in no particular order.
+
+const int HASHBUCKETDATA = PAGESIZE - 3 * sizeof(int);
+
+struct HashBucket
+{
+  int		localDepth;	// bits of the hash shared by the bucket
+  int		keyCnt;		// number of entries on this page
+  int		overflowPage;	// next page of the bucket, -1 if none
+  char		data[HASHBUCKETDATA];
+};
+
+
+// routines to create and destroy the file of an index; the directory
+// starts with at least bucketCnt buckets
+extern const Status createHashIndex(const string fileName,
+				    const Datatype keyType,
+				    const int keyLen,
+				    const int bucketCnt);
+extern const Status destroyHashIndex(const string fileName);
+
+
+class HashIndex
+{
+public:
+  // open the index in file fileName
+  HashIndex(const string & fileName, Status & status);
+
+  // end any scan and close the file
+  ~HashIndex();
+
+  // add the entry (key, rid); key points to keyLen bytes
+  const Status insertEntry(const char* key, const RID & rid);
+
+  // remove the entry (key, rid), RECNOTFOUND if there is none
+  const Status deleteEntry(const char* key, const RID & rid);
+
+  // start a scan of the entries with key
+  const Status startScan(const char* key);
+
+  // return the RID of the next entry of the scan, NOMORERECS at the end
+  const Status scanNext(RID & rid);
+
+  // end the scan
+  const Status endScan();
+
+  const int getEntryCnt() const { return headerPage->entryCnt; }
+  const int getGlobalDepth() const { return headerPage->globalDepth; }
+  const int getBucketCnt() const { return headerPage->bucketCnt; }
+  const int getOverflowCnt() const { return headerPage->overflowCnt; }
+
+private:
+  File*		filePtr;	// underlying DB File object
+  HashHdrPage*	headerPage;	// pinned header page
+  int		headerPageNo;
+  bool		hdrDirtyFlag;
+  Datatype	keyType;
+  int		keyLen;
+  int		entryLen;	// key + RID
+  int		bucketCap;	// max # entries of a page
+
+  // scan state; the current page of the bucket stays pinned
+  int		scanPageNo;	// -1 if no scan is active
+  HashBucket*	scanPage;
+  int		scanPos;	// next entry of scanPage
+  vector<char>	scanKey;
+
+  // hash value of a key, and whether two keys are equal
+  const unsigned int hashKey(const char* key) const;
+  const bool keyEq(const char* a, const char* b) const;
+
+  char* bucketEntry(HashBucket* bucket, const int i) const
+  {
+    return bucket->data + i * entryLen;
+  }
+
+  // read and write slot i of the directory
+  const Status getSlot(const int i, int & pageNo);
+  const Status setSlot(const int i, const int pageNo);
+
+  // page of the bucket holding the keys of hash value h
+  const Status findBucket(const unsigned int h, int & pageNo);
+
+  // double the directory, DIROVERFLOW if it would grow too large
+  const Status doubleDirectory();
+
+  // split the bucket on page pageNo, which holds the keys of hash
+  // value h, by the next bit of the hash
+  const Status splitBucket(const int pageNo, const unsigned int h);
+
+  // add entry to the bucket on page pageNo; BUCKETFULL if it has no
+  // room, in which case alike tells whether the entries looked at all
+  // have the same hash value
+  const Status addToBucket(const int pageNo, const char* entry,
+			   bool & alike);
+
+  // add an overflow page holding entry to the bucket on page pageNo
+  const Status addOverflow(const int pageNo, const char* entry);
+
+  // store entries in the pages of the bucket on page pageNo, reusing
+  // its overflow pages and adding or disposing of pages as needed
+  const Status writeBucket(const int pageNo, const int localDepth,
+			   const vector<char> & entries);
+};
+
+#endif
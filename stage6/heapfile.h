@@ -21,9 +21,53 @@ extern DB db;
 // Some constant definitions
 const unsigned MAXNAMESIZE = 50;
 
+// number of tuples between reorderings of a conjunctive scan predicate
+const int REORDERINTERVAL = 100;
+
+// number of data pages examined by one HeapFile::vacuum() call
+const int VACUUMPAGES = 32;
+
+// max number of attributes of a file that can have zone maps
+const int MAXZONEATTRS = 4;
+
+// bytes of an attribute value kept as a zone map bound; longer
+// strings are bounded by their prefix
+const int ZONEKEYLEN = 8;
+
 enum Datatype { STRING, INTEGER, FLOAT };    // attribute data types
 enum Operator { LT, LTE, EQ, GTE, GT, NE };  // scan operators
 
+// an attribute of a file for which zone maps are kept
+
+struct ZoneAttr
+{
+  int		offset;		// byte offset of attribute
+  int		length;		// length of attribute
+  Datatype	type;		// datatype of attribute
+};
+
+// One conjunct of a scan predicate.  The attribute at (offset, length)
+// is compared either against the value pointed to by filter or, if
+// offset2 is >= 0, against a second attribute of the same tuple that
+// starts at offset2 and has the same type and length.
+
+struct ScanPred
+{
+  int		offset;		// byte offset of filter attribute
+  int		length;		// length of filter attribute
+  Datatype	type;		// datatype of filter attribute
+  const char*	filter;		// comparison value (unused if offset2 >= 0)
+  Operator	op;		// comparison operator
+  int		offset2;	// offset of second attribute, -1 if none
+};
+
+// A test a scan applies to each record that satisfies its predicate,
+// such as a probe of a hash join's Bloom filter.  It is passed the
+// record and the argument it was installed with, and the scan skips
+// the record if it returns false.
+
+typedef const bool (*RecFilter)(const Record & rec, const void* arg);
+
 struct FileHdrPage
 {
   char		fileName[MAXNAMESIZE];   // name of file
@@ -31,6 +75,80 @@ struct FileHdrPage
   int		lastPage;	// pageNo of last data page in file
   int		pageCnt;	// number of pages
   int		recCnt;		// record count
+  int		dirFirstPage;	// pageNo of first page directory page
+  int		dirLastPage;	// pageNo of last page directory page
+  int		dirVersion;	// bumped whenever directory pages are rearranged
+  int		zoneAttrCnt;	// number of attributes with zone maps
+  ZoneAttr	zoneAttrs[MAXZONEATTRS];
+  int		zoneFirstPage;	// pageNo of first zone map page, -1 if none
+  int		zoneLastPage;	// pageNo of last zone map page, -1 if none
+  int		vacuumCursor;	// directory index where the next vacuum starts
+};
+
+
+// The page directory lists the data pages of a heap file in the same
+// order as the nextPage chain, so that the k-th data page can be found
+// without reading the k-1 pages in front of it.  It is stored in a
+// chain of DirPages starting at FileHdrPage::dirFirstPage.  Every
+// directory page except the last one is full.
+
+struct DirEntry
+{
+  int		pageNo;		// pageNo of data page
+  int		recCnt;		// number of records on the page
+};
+
+const int DIRENTRIES = (PAGESIZE - 2 * sizeof(int)) / sizeof(DirEntry);
+
+struct DirPage
+{
+  int		nextDirPage;	// pageNo of next directory page, -1 if none
+  int		entryCnt;	// number of entries in use
+  DirEntry	entries[DIRENTRIES];
+};
+
+
+// Zone maps keep, for every data page, the smallest and largest value
+// that each of the file's zone attributes takes on the page, so that
+// a scan can pass over pages that cannot hold a matching record.  The
+// entries are stored in a chain of ZonePages parallel to the page
+// directory: entry idx describes the data page of directory entry idx.
+// The bounds may be wider than the records of the page.
+
+struct ZoneEntry
+{
+  int		valid;		// 0 if the bounds are undefined (no records)
+  char		lo[MAXZONEATTRS][ZONEKEYLEN];	// lower bounds
+  char		hi[MAXZONEATTRS][ZONEKEYLEN];	// upper bounds
+};
+
+const int ZONEENTRIES = (PAGESIZE - 2 * sizeof(int)) / sizeof(ZoneEntry);
+
+struct ZonePage
+{
+  int		nextZonePage;	// pageNo of next zone map page, -1 if none
+  int		entryCnt;	// number of entries in use
+  ZoneEntry	entries[ZONEENTRIES];
+};
+
+
+// statistics of a HeapFileScan
+
+struct ScanStats
+{
+  int pagesRead;     // Number of data pages pinned by the scan
+  int pagesSkipped;  // Number of data pages passed over without pinning
+  int tuplesFiltered; // Number of matching tuples rejected by the filter
+
+  void clear()
+    {
+      pagesRead = pagesSkipped = tuplesFiltered = 0;
+    }
+
+  ScanStats()
+    {
+      clear();
+    }
 };
 
 
@@ -46,6 +164,59 @@ protected:
    int   	curPageNo;	// page number of pinned page
    bool  	curDirtyFlag;   // true if page has been updated
    RID   	curRec;         // rid of last record returned
+   int		curPageIdx;	// directory index of pinned page, -1 if unknown
+
+   vector<int>	dirPageNos;	// cached pageNos of the directory pages
+   vector<int>	zonePageNos;	// cached pageNos of the zone map pages
+   int		dirCacheVersion; // dirVersion the caches were built for
+
+   // find page pos of the directory or zone map page chain
+   const Status findChainPage(vector<int>& pageNos, const int firstPageNo,
+			      const unsigned int pos, int& pageNo);
+
+   // pin the directory page holding entry idx
+   const Status readDirPage(const int idx, int& dirPageNo, DirPage*& dirPage);
+
+   // add a data page at the end of the directory
+   const Status appendDirEntry(const int pageNo);
+
+   // add delta to the record count of directory entry idx
+   const Status adjustDirRecCnt(const int idx, const int delta);
+
+   // overwrite directory entry idx
+   const Status setDirEntry(const int idx, const DirEntry& entry);
+
+   // drop the sorted directory (and zone map) entries in removed[]
+   const Status removeDirEntries(const vector<int>& removed);
+
+   // cut a directory or zone map page chain down to entryCnt entries
+   const Status truncateChain(const int firstPageNo, int& lastPageNo,
+			      const int perPage, const int entryCnt);
+
+   // move the records of page src into page dest until dest is full,
+   // appending the old and new RID of each record to moves
+   const Status movePageRecords(const int srcIdx, Page* src,
+				const int destIdx, Page* dest,
+				vector<pair<RID, RID> >& moves);
+
+   // pin the zone map page holding entry idx
+   const Status readZonePage(const int idx, int& zonePageNo,
+			     ZonePage*& zonePage);
+
+   // add an empty zone map entry at the end of the zone map pages
+   const Status appendZoneEntry();
+
+   // overwrite zone map entry idx
+   const Status setZoneEntry(const int idx, const ZoneEntry& entry);
+
+   // widen the zone map bounds of entry idx to include rec
+   const Status widenZone(const int idx, const Record& rec);
+
+   // recompute the zone map bounds of entry idx from data page page
+   const Status recomputeZone(const int idx, Page* page);
+
+   // widen the bounds of entry to include rec
+   void widenZoneEntry(ZoneEntry& entry, const Record& rec) const;
 
 public:
 
@@ -58,8 +229,35 @@ public:
   // return number of records in file
   const int getRecCnt() const;
 
+  // return number of data pages in file
+  const int getPageCnt() const;
+
+  // look up directory entry idx (0 <= idx < getPageCnt())
+  const Status getDirEntry(const int idx, DirEntry& entry);
+
+  // look up zone map entry idx (0 <= idx < getPageCnt())
+  const Status getZoneEntry(const int idx, ZoneEntry& entry);
+
+  // start keeping zone maps for the attribute at (offset, length)
+  const Status addZoneAttr(const int offset, const int length,
+			   const Datatype type);
+
+  // split the data pages into parts nearly equal ranges and return
+  // range part as [firstIdx, endIdx)
+  void getPageRange(const int part, const int parts,
+		    int& firstIdx, int& endIdx) const;
+
   // given a RID, read record from file, returning pointer and length
   const Status getRecord(const RID &rid, Record & rec);
+
+  // read the records of rids[0..cnt-1] visiting each page only once;
+  // recs[i] is set to a copy of record rids[i] that is kept in buf
+  const Status getRecords(const int cnt, const RID rids[], Record recs[],
+			  vector<char>& buf);
+
+  // compact the next VACUUMPAGES data pages, see heapfile.C
+  const Status vacuum(int& firstIdx, int& endIdx, int& pagesFreed,
+		      vector<pair<RID, RID> >& moves, bool& passDone);
 };
 
 
@@ -78,6 +276,22 @@ public:
                            const char* filter, 
                            const Operator op);
 
+    // start a scan whose predicate is the conjunction of preds[]
+    const Status startScan(const int predCnt, const ScanPred preds[]);
+
+    // restrict the scan to data pages [firstIdx, endIdx) of the file;
+    // endIdx of -1 means through the end of the file
+    const Status setPageRange(const int firstIdx, const int endIdx);
+
+    // skip records for which filter(rec, arg) is false, counting them
+    // in the scan statistics; a NULL filter tests nothing.  The filter
+    // stays in place across startScan()s.
+    void setRecFilter(const RecFilter filter, const void* arg)
+    {
+      recFilter = filter;
+      recFilterArg = arg;
+    }
+
     const Status endScan(); // terminate the scan
     const Status markScan(); // save current position of scan
     const Status resetScan(); // reset scan to last marked location
@@ -94,21 +308,51 @@ public:
     // marks current page of scan dirty
     const Status markDirty();
 
+    // true if rec satisfies pred
+    static const bool matchPred(const ScanPred & pred, const Record & rec);
+
+    // return page counts of the scan since startScan()
+    const ScanStats & getScanStats() const
+    {
+      return scanStats;
+    }
+
 private:
-    int   offset;            // byte offset of filter attribute
-    int   length;            // length of filter attribute
-    Datatype type;           // datatype of filter attribute
-    const char* filter;      // comparison value of filter
-    Operator op;             // comparison operator of filter
+    // Conjuncts of the scan predicate together with the statistics
+    // used to order them.  Every REORDERINTERVAL tuples the conjuncts
+    // are re-sorted so that the one with the lowest cost per tuple
+    // rejected is evaluated first.
+    struct PredState {
+      ScanPred pred;
+      float cost;            // static estimate of evaluation cost
+      int evalCnt;           // # times evaluated since last decay
+      int passCnt;           // # times satisfied since last decay
+    };
+    vector<PredState> preds; // empty if no filtering requested
+    int   evalSinceReorder;  // tuples matched since last reordering
+    ScanStats scanStats;     // pages read and skipped by the scan
+    RecFilter recFilter;     // record filter, NULL if none
+    const void* recFilterArg; // argument of recFilter
 
      // The following variables are used to preserve the state
     // of the scan when the method markScan() is invoked.
     // A subsequent invocation of resetScan() will cause the
     // scan to be rolled back to the following
     int   markedPageNo;	// page number of pinned page
+    int   markedPageIdx;     // directory index of pinned page
     RID   markedRec;         // rid of last record returned
 
-    const bool matchRec(const Record & rec) const;
+    int   firstPageIdx;      // first data page of the scan range
+    int   endPageIdx;        // end of scan range, -1 for end of file
+
+    // unpin the current page and pin the next one in the scan range
+    const Status nextPage();
+
+    // true if no record within the bounds of entry can match
+    const bool zoneExcludes(const ZoneEntry & entry) const;
+
+    const bool matchRec(const Record & rec);
+    void reorderPreds();
 };
 
 
@@ -0,0 +1,38 @@
+#ifndef INDEX_H
+#define INDEX_H
+
+#include "catalog.h"
+#include "btree.h"
+#include "hashindex.h"
+#include "bitmapindex.h"
+
+
+// The indexes of one relation, opened together so that a tuple
+// inserted into or deleted from the relation can be entered in or
+// removed from each of them.
+
+class RelIndexes {
+ public:
+  // open every index of relation
+  RelIndexes(const string & relation, Status & status);
+
+  // close the indexes
+  ~RelIndexes();
+
+  // true if the relation has no index
+  const bool empty() const { return indexes.empty(); }
+
+  // enter tuple rec with RID rid in every index
+  const Status insertEntries(const Record & rec, const RID & rid);
+
+  // remove tuple rec with RID rid from every index
+  const Status deleteEntries(const Record & rec, const RID & rid);
+
+ private:
+  vector<IndexDesc> indexes;            // idxcat tuples of the indexes
+  vector<BTreeIndex*> btrees;           // open index of indexes[i], all
+  vector<HashIndex*> hashes;            // but one of the three being
+  vector<BitmapIndex*> bitmaps;         // NULL
+};
+
+#endif
@@ -1,40 +1,112 @@
+// A hash table of the build tuples of a hash join.  The tuples are
+// copied one after another into an arena, and each distinct value of
+// the join attribute takes a slot of a flat open-addressing table,
+// probed linearly, which holds its hash value and its first tuple.  The
+// other tuples with that value are chained to the first, so duplicates
+// do not lengthen the probe sequences of other values.  Nothing is
+// allocated per tuple, and a probe allocates nothing at all.
 
 class joinHashTbl
 {
 private:
-    union JAttrType
+    struct Entry
     {
-	int iValue;
-	float fValue;
-	char* sValue;
-    };
-	
-    struct joinhashBucket
-    {
-	union JAttrType	attrValue;
-       	RID	rid;
-       	joinhashBucket*     next;    // next node in the hash table
+	int	offset;		// offset of the tuple in the arena
+	int	next;		// next entry with the same value, -1 if none
     };
 
-    struct HTentry
+    struct Slot
     {
-	int bucketCnt;  // nuumber of buckets on this chain
-	joinhashBucket*   chain;  // pointer to first bucket on the chain
+	unsigned int hash;	// hash value of the join attribute
+	int	entry;		// first entry with the value, -1 if empty
     };
 
     AttrDesc 	joinAttr;
-    int 	HTSIZE;
-    HTentry 	*ht; // actual hash table
-    int  hash(const char* attr, int attrType); // returns value between 0 and HTSIZE-1
+    vector<char> arena;		// the build tuples
+    vector<Entry> entries;	// an entry per build tuple
+    vector<Slot> slots;		// a power of two of them
+    unsigned int mask;		// slots.size() - 1
+    int		valueCnt;	// number of slots in use
+
+    const unsigned int hash(const char* attrPtr) const;
+    const bool equal(const char* a, const char* b) const;
+
+    // the slot holding the value at attrPtr, whose hash value is h, or
+    // the empty slot where it belongs
+    const unsigned int findSlot(const char* attrPtr,
+				const unsigned int h) const;
+
+    // double the number of slots
+    void grow();
 
 public:
-    joinHashTbl(const int size, const AttrDesc attr);  // constructor
-    ~joinHashTbl();
+    // a table sized for about tupleCnt build tuples; it grows if more
+    // are inserted
+    joinHashTbl(const int tupleCnt, const AttrDesc attr);
+
+    // copy the build tuple rec into the table
+    Status insert(const Record & rec);
+
+    // the first build tuple whose join attribute equals the value at
+    // probeAttrPtr, or NULL if there is none.  pos is set so that
+    // next() returns the others.  The tuples are owned by the table.
+    const char* probe(const char* probeAttrPtr, int & pos) const
+    {
+	unsigned int h = hash(probeAttrPtr);
+	pos = slots[findSlot(probeAttrPtr, h)].entry;
+	return pos < 0 ? NULL : &arena[entries[pos].offset];
+    }
+
+    // the next build tuple matching the value of the last probe, or NULL
+    const char* next(int & pos) const
+    {
+	pos = entries[pos].next;
+	return pos < 0 ? NULL : &arena[entries[pos].offset];
+    }
+
+    const int getTupCnt() const { return entries.size(); }
+};
+
+// A blocked Bloom filter of the join attribute values of the build
+// tuples of a hash join, used to drop probe tuples that cannot match
+// before they are probed or partitioned.  The bits are cut into blocks
+// of one cache line; a value sets BLOOMHASHES bits of a single block,
+// so a test touches one cache line.  A value that was added always
+// passes; about one percent of the others pass too.
+
+class joinBloomFilter
+{
+private:
+    enum { BLOCKWORDS = 16, BLOCKBITS = 32 * BLOCKWORDS,
+	   BITSPERVALUE = 10, BLOOMHASHES = 7 };
+
+    AttrDesc	buildAttr;	// attribute the values are added from
+    AttrDesc	probeAttr;	// attribute recFilter() tests
+    vector<unsigned int> bits;
+    unsigned int blockCnt;
+
+    const unsigned int hash(const char* attrPtr) const;
+
+public:
+    // a filter sized for about valueCnt values
+    joinBloomFilter(const int valueCnt, const AttrDesc buildAttr,
+		    const AttrDesc probeAttr);
+
+    // add the join attribute value of build tuple rec
+    void add(const Record & rec);
 
-     // insert a new (JoinAttrValue, RID) pair into hash table
-     Status insert(const RID newRid,  const char* tuple);
+    // false if no build tuple has the join attribute value at attrPtr
+    const bool mayContain(const char* attrPtr) const;
 
-     // get RIDs of records whose join attribute value matches innerJoinAttrValue
-     Status lookup(const char* innerJoinAttrPtr, int & ridCount, RID *&outRids);
+    // a RecFilter passing the probe tuples that may have a match; arg
+    // is the filter
+    static const bool recFilter(const Record & rec, const void* arg);
 };
 
+// hash value of a join attribute value of type attrType and length
+// attrLen.  Values that compare equal in a join hash alike; seed picks
+// one of a family of independent hash functions.
+extern const unsigned int joinHash(const char* attrPtr,
+				   const int attrType,
+				   const int attrLen,
+				   const unsigned int seed);
@@ -53,12 +53,18 @@ typedef enum {
     N_DESTROY,
     N_BUILD,
     N_REBUILD,
+    N_BITMAP,
     N_DROP,
+    N_ZONEMAP,
+    N_VACUUM,
+    N_ANALYZE,
     N_LOAD,
     N_PRINT,
     N_HELP,
     N_SELECT,
     N_JOIN,
+    N_BAND,
+    N_BOUND,
     N_PRIMATTR,
     N_QUALATTR,
     N_ATTRVAL,
@@ -82,6 +88,7 @@ typedef struct node {
 	    char *relname;
 	    struct node *attrlist;
 	    struct node *qual;
+	    struct node *tablelist;
 	} QUERY;
 
 	// insert node */
@@ -113,6 +120,7 @@ typedef struct node {
 	    char *relname;
 	    char *attrname;
 	    int nbuckets;
+	    struct node *incllist;
 	} BUILD;
 
 	// drop node */
@@ -121,6 +129,22 @@ typedef struct node {
 	    char *attrname;
 	} DROP;
 
+	// zonemap node */
+	struct {
+	    char *relname;
+	    char *attrname;
+	} ZONEMAP;
+
+	// vacuum node */
+	struct {
+	    char *relname;
+	} VACUUM;
+
+	// analyze node */
+	struct {
+	    char *relname;
+	} ANALYZE;
+
 	// load node */
 	struct {
 	    char *relname;
@@ -151,6 +175,19 @@ typedef struct node {
 	    struct node *joinattr2;
 	} JOIN;
 
+	// band join node: joinattr1 between two bounds */
+	struct {
+	    struct node *joinattr1;
+	    struct node *lowbound;
+	    struct node *highbound;
+	} BAND;
+
+	// bound of a band join: an attribute plus an offset */
+	struct {
+	    struct node *attr;
+	    double offset;
+	} BOUND;
+
 	// qualified attribute node */
 	struct {
 	    char *relname;
@@ -212,19 +249,26 @@ typedef struct node {
 //
 
 NODE *newnode(int kind);
-NODE *query_node(char *relname, NODE *attrlist, NODE *n);
+NODE *query_node(char *relname, NODE *attrlist, NODE *n, NODE *tablelist);
 NODE *insert_node(char *relname, NODE *attrlist);
 NODE *delete_node(char *relname, NODE *qual);
 NODE *create_node(char *relname, NODE *attrlist, NODE *primattr);
 NODE *destroy_node(char *relname);
-NODE *build_node(char *relname, char *attrname, int nbuckets);
+NODE *build_node(char *relname, char *attrname, int nbuckets,
+		 NODE *incllist);
 NODE *rebuild_node(char *relname, char *attrname, int nbuckets);
+NODE *bitmap_node(char *relname, char *attrname);
 NODE *drop_node(char *relname, char *attrname);
+NODE *zonemap_node(char *relname, char *attrname);
+NODE *vacuum_node(char *relname);
+NODE *analyze_node(char *relname);
 NODE *load_node(char *relname, char *filename);
 NODE *print_node(char *relname);
 NODE *help_node(char *relname);
 NODE *select_node(NODE *selattr, int op, NODE *value);
 NODE *join_node(NODE *joinattr1, int op, NODE *joinattr2);
+NODE *band_node(NODE *joinattr1, NODE *lowbound, NODE *highbound);
+NODE *bound_node(NODE *attr, double offset);
 NODE *qualattr_node(char *relname, char *attrname);
 NODE *primattr_node(char *attrname, int nbuckets);
 NODE *attrval_node(char *attrname, NODE *value);
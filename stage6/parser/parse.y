@@ -23,6 +23,7 @@ static NODE *parse_tree;                // root of parse tree
 %union{
   int ival;
   float rval;
+  double dval;
   char *sval;
   NODE *n;
 }
@@ -30,7 +31,11 @@ static NODE *parse_tree;                // root of parse tree
 %token  	RW_CREATE
 		RW_BUILD
 		RW_REBUILD
+		RW_BITMAP
 		RW_DROP
+		RW_ZONEMAP
+		RW_VACUUM
+		RW_ANALYZE
 		RW_DESTROY
 		RW_PRINT
 		RW_LOAD
@@ -51,6 +56,8 @@ static NODE *parse_tree;                // root of parse tree
 		RW_OR
 		RW_NOT
 		RW_VALUES	
+		RW_INCLUDE
+		RW_BETWEEN
 		INT_TYPE
 		REAL_TYPE
 		CHAR_TYPE	
@@ -74,6 +81,8 @@ static NODE *parse_tree;                // root of parse tree
 
 %type	<ival>	op
 
+%type	<dval>	offset
+
 %type	<sval>	opt_into_relname
 		opt_relname
 		string
@@ -85,19 +94,25 @@ static NODE *parse_tree;                // root of parse tree
 		create
 		destroy
 		build
-/*
 		rebuild
-*/
+		bitmap
 		drop
+		zonemap
+		vacuum
+		analyze
 		load
 		print
 		help
 		quit
 		opt_primary_attr
+		opt_include
 		opt_where
+		conj
 		qual
 		selection
 		join
+		band
+		bound
 		non_mt_qualattr_list
 		qualattr
 /*
@@ -148,10 +163,12 @@ command
 	| create
 	| destroy
 	| build
-/*
 	| rebuild
-*/
+	| bitmap
 	| drop
+	| zonemap
+	| vacuum
+	| analyze
 	| load
 	| print
 	| help
@@ -177,7 +194,7 @@ query
 		     $$ = NULL; //something wrong in where condition
 		  }
 		  else {
-		    $$ = query_node($3, qualattr_list, where);
+		    $$ = query_node($3, qualattr_list, where, $5);
 		  }
 		}
 	}
@@ -270,20 +287,25 @@ destroy
 	;
 
 build
-	: RW_BUILD string '(' string ')'
+	: RW_BUILD string '(' string ')' opt_include
 	{
-		$$ = build_node($2, $4, 0);
+		$$ = build_node($2, $4, 0, $6);
 	}
 	;
 
-/*
 rebuild
 	: RW_REBUILD string '(' string ')' RW_NUMBUCKETS T_EQ T_INT
 	{
 		$$ = rebuild_node($2, $4, $8);
 	}
 	;
-*/
+
+bitmap
+	: RW_BITMAP string '(' string ')'
+	{
+		$$ = bitmap_node($2, $4);
+	}
+	;
 
 drop
 	: RW_DROP string '(' string ')'
@@ -296,6 +318,31 @@ drop
 	}
 	;
 
+zonemap
+	: RW_ZONEMAP string '(' string ')'
+	{
+		$$ = zonemap_node($2, $4);
+	}
+	;
+
+vacuum
+	: RW_VACUUM RW_TABLE string
+	{
+		$$ = vacuum_node($3);
+	}
+	;
+
+analyze
+	: RW_ANALYZE string
+	{
+		$$ = analyze_node($2);
+	}
+	| RW_ANALYZE RW_TABLE string
+	{
+		$$ = analyze_node($3);
+	}
+	;
+
 load
 	: RW_LOAD RW_TABLE string RW_FROM '(' T_QSTRING ')'
 	{
@@ -334,6 +381,17 @@ opt_primary_attr
 	}
 	;
 
+opt_include
+	: RW_INCLUDE '(' attrib_list ')'
+	{
+		$$ = $3;
+	}
+	| nothing
+	{
+		$$ = NULL;
+	}
+	;
+
 opt_into_relname
 	: RW_INTO string
 	{
@@ -357,7 +415,7 @@ opt_relname
 	;
 	
 opt_where
-	: RW_WHERE qual
+	: RW_WHERE conj
 	{
 		$$ = $2;
 	}
@@ -367,9 +425,18 @@ opt_where
 	}
 	;
 
+conj
+	: qual
+	| qual RW_AND conj
+	{
+		$$ = prepend($1, ($3->kind == N_LIST) ? $3 : list_node($3));
+	}
+	;
+
 qual
 	: selection
 	| join
+	| band
 	;
 
 selection
@@ -386,6 +453,44 @@ join
 	}
 	;
 
+band
+	: qualattr RW_BETWEEN bound RW_AND bound
+	{
+		$$ = band_node($1, $3, $5);
+	}
+	;
+
+bound
+	: qualattr
+	{
+		$$ = bound_node($1, 0);
+	}
+	| qualattr '+' offset
+	{
+		$$ = bound_node($1, $3);
+	}
+	| qualattr '-' offset
+	{
+		$$ = bound_node($1, -$3);
+	}
+	| qualattr offset
+	{
+		/* b.y-5 scans as b.y followed by the number -5 */
+		$$ = bound_node($1, $2);
+	}
+	;
+
+offset
+	: T_INT
+	{
+		$$ = $1;
+	}
+	| T_REAL
+	{
+		$$ = $1;
+	}
+	;
+
 non_mt_qualattr_list
 	: '(' non_mt_qualattr_list ')'
 	{
@@ -14,10 +14,15 @@ class Partition {
 	    const string & fileName,             // (base) name of heap file
 	    const int P,                      // number of partitions
 	    const int (*hashfcn)(const Record & rec,
-				 const int P),  
+				 const int P, void *arg),  
 	                               // hash function to use in partitioning
+	    void *arg,                  // passed to hashfcn and keepfcn
 	    string* &partName,           // names of partitioned heap files
-	    Status &status);            // create partitions of file
+	    Status &status,             // create partitions of file
+	    const Status (*keepfcn)(const Record & rec,
+				    void *arg) = NULL);
+	                               // takes the records of partition 0
+	                               // instead of its file, if given
   ~Partition();                         // destroy partitions
 
  private:
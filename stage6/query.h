@@ -2,8 +2,121 @@
 #define QUERY_H
 
 #include "heapfile.h"
+#include "catalog.h"
+
+// AutoJoin lets QU_Join pick the method with the cost model
+enum JoinType {NLJoin, SMJoin, HashJoin, IndexNLJoin, GraceJoin, HybridJoin,
+               ParallelJoin, BandJoin, AutoJoin};
+
+// buffer frames kept back from a join for the header and current
+// pages of its scans and of the result relation
+#define JOINRESERVE 6
+
+// number of outer tuples whose index probes an index nested loops
+// join gathers before fetching the matching inner tuples
+#define INLJOINBATCH 64
+
+// a Grace hash join with bufs buffer frames joins build partitions of
+// up to bufs pages in memory, and splits a file into at most
+// GRACEFANOUT(bufs) partitions at once.  A partition being written
+// pins its header and last page and updates its directory page with
+// every tuple, so it is given three frames.  Partitions still too
+// large after GRACEMAXDEPTH levels of partitioning are joined block
+// by block.
+#define GRACEFANOUT(bufs) ((bufs) >= 6 ? (bufs) / 3 : 2)
+#define GRACEMAXDEPTH 3
+
+// seeds of joinHash.  Level d of Grace or hybrid partitioning hashes
+// with seed d < GRACEMAXDEPTH, so every level splits the tuples anew.
+// The tuples of one partition share the hash bits of its level, so the
+// join hash table, the Bloom filter and the radix partitioning of the
+// parallel hash join each hash with a seed of their own, which spreads
+// such tuples over all of their slots, blocks and partitions.
+#define HASHTBLSEED (GRACEMAXDEPTH + 1)
+#define BLOOMSEED (GRACEMAXDEPTH + 2)
+#define RADIXSEED (GRACEMAXDEPTH + 3)
+
+// most worker threads of a parallel hash join, and partitions made
+// per worker, so that workers finishing early can be given more
+#define MAXJOINTHREADS 64
+#define PJOINPARTSPERTHREAD 4
+
+// most relations a multi-way join may involve
+#define MAXJOINRELS 10
+
+//
+// JoinPlan: the join method chosen for a join and its estimated cost.
+// Costs are in page reads, with the CPU work per tuple charged as a
+// fraction of a page read.
+//
+
+typedef struct {
+  JoinType method;                      // join algorithm
+  bool swap;                            // attr2's relation is the outer
+                                        // (build) input
+  double cost;                          // estimated cost
+  double resultCnt;                     // estimated # result tuples
+} JoinPlan;
+
+//
+// JoinStep: one join of a multi-way join plan.  The tuples of the
+// relations joined so far flow into it, and are joined with relation
+// rel by method on join condition cond, or paired with every tuple of
+// rel if cond is -1.
+//
+
+typedef struct {
+  int rel;                              // relation joined in
+  int cond;                             // condition the method evaluates
+  JoinType method;                      // NLJoin, HashJoin or IndexNLJoin
+} JoinStep;
+
+//
+// MultiJoinPlan: a left-deep plan for a join of relCnt relations.
+// Relation first is scanned and each of its tuples passes through
+// steps[0], ..., steps[relCnt - 2] in turn; no intermediate result is
+// stored as a relation.
+//
+
+typedef struct {
+  int relCnt;                           // # relations joined
+  int first;                            // relation scanned
+  JoinStep steps[MAXJOINRELS - 1];      // joins in order
+  double cost;                          // estimated cost
+  double resultCnt;                     // estimated # result tuples
+} MultiJoinPlan;
+
+//
+// BandPred: the predicate of a band join between outer attribute x and
+// inner attribute y,
+//
+//	y + low <= x <= y + high
+//
+// where either comparison may be strict or missing.  x < y, for one,
+// is y + 0 > x with no lower bound.  Offsets must be 0 for strings.
+//
+
+typedef struct {
+  bool hasLow;                          // x is bounded below
+  bool lowStrict;                       // y + low < x
+  double low;
+  bool hasHigh;                         // x is bounded above
+  bool highStrict;                      // x < y + high
+  double high;
+} BandPred;
+
+//
+// condInfo: one conjunct of a where clause.  Either `attr op value',
+// in which case attr.attrValue holds the value in string form, or
+// `attr op attr2' where attr2.attrName is non-empty.
+//
+
+typedef struct {
+  attrInfo attr;                        // left-hand attribute
+  Operator op;                          // comparison operator
+  attrInfo attr2;                       // right-hand attribute, if any
+} condInfo;
 
-enum JoinType {NLJoin, SMJoin, HashJoin};
 
 //
 // Prototypes for query layer functions
@@ -13,9 +126,8 @@ enum JoinType {NLJoin, SMJoin, HashJoin};
 const Status QU_Select(const string & result, 
 		       const int projCnt, 
 		       const attrInfo projNames[],
-		       const attrInfo *attr, 
-		       const Operator op, 
-		       const char *attrValue);
+		       const int condCnt,
+		       const condInfo conds[]);
 
 const Status QU_Join(const string & result, 
 		     const int projCnt, 
@@ -24,6 +136,64 @@ const Status QU_Join(const string & result,
 		     const Operator op, 
 		     const attrInfo *attr2);
 
+// join the relations of attr1 and attr2 on attr2 + low <= attr1 <=
+// attr2 + high, as in `attr1 BETWEEN attr2 - k AND attr2 + k'
+const Status QU_BandJoin(const string & result,
+			 const int projCnt,
+			 const attrInfo projNames[],
+			 const attrInfo *attr1,
+			 const BandPred & band,
+			 const attrInfo *attr2);
+
+// choose the join method and outer relation of a join; if method is
+// not AutoJoin only the outer relation is chosen
+const Status QU_PlanJoin(const attrInfo *attr1,
+			 const Operator op,
+			 const attrInfo *attr2,
+			 const JoinType method,
+			 JoinPlan & plan);
+
+// join the relations relNames[] of the from list, where the
+// conjunction of conds[] is the where clause; conds[] are those of
+// QU_Select, but may span any number of the relations
+const Status QU_MultiJoin(const string & result,
+			  const int projCnt,
+			  const attrInfo projNames[],
+			  const int relCnt,
+			  const string relNames[],
+			  const int condCnt,
+			  const condInfo conds[]);
+
+// choose the order in which a multi-way join joins relations
+// relNames[] and the method of each join; if method is a method a
+// step can use, every step uses it where it applies
+const Status QU_PlanMultiJoin(const int relCnt,
+			      const string relNames[],
+			      const int condCnt,
+			      const condInfo conds[],
+			      const JoinType method,
+			      MultiJoinPlan & plan);
+
+// buffer frames a join has for its working memory: the frames holding
+// no pinned page, less JOINRESERVE
+const int QU_JoinFrames();
+
+// divides bufs frames between the partitions of a hybrid hash join
+// whose build relation has buildPages pages: spillCnt partitions are
+// written out, each of which pins three frames while it is written,
+// and residentPages pages of build tuples are kept in memory
+void QU_HybridSplit(const int buildPages,
+                    const int bufs,
+                    int & spillCnt,
+                    int & residentPages);
+
+// worker threads of a parallel hash join, 0 for one per core
+extern int JoinThreads;
+
+// threads a parallel hash join runs: JoinThreads, or the number of
+// cores if it is 0, at most MAXJOINTHREADS
+const int QU_JoinThreads();
+
 const Status QU_Insert(const string & relation, 
 		       const int attrCnt, 
 		       const attrInfo attrList[]);
@@ -56,6 +56,7 @@ class SortedFile {
   int length;                           // length of sort attribute
 
   SORTREC* buffer;                      // in-memory sort buffer
+  char* keys;                           // sort attributes of buffer[]
   int maxItems;                         // max. # of items/tuples in buffer
   int numItems;                         // current # of items in buffer
 };